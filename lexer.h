@@ -1,11 +1,58 @@
 #include <vector>
 #include <string>
+#include <string_view>
 #include "token.h"
 #ifndef FUNCTIONS_H
 #define FUNCTIONS_H
 
 std::vector<std::string> getTokens(std::string );
 
+// Run-skipping kernels used by BufferLexer. Each returns the first byte in
+// [p, end) that ends the run; there are scalar, SSE2 and AVX2 versions.
+struct ScanKernels {
+    const char* name;
+    const char* (*skipWhitespace)(const char* p, const char* end, int& newlines, const char*& lastNewline);
+    const char* (*skipIdentifier)(const char* p, const char* end);
+    const char* (*skipDigits)(const char* p, const char* end);
+    const char* (*findByte)(const char* p, const char* end, char byte);
+};
+
+// Function to choose the scan kernels ("auto", "scalar", "sse2" or "avx2") for
+// lexers created afterwards; returns false if the CPU or build lacks them.
+// By default the widest supported kernels are used.
+bool selectScanKernels(const std::string& name);
+const char* scanKernelsName();
+
+// Lexer that scans a memory buffer (a mapped file or a caller-supplied buffer)
+// with a character class table and SIMD run-skipping kernels. Tokens refer to
+// their text in the buffer, which must outlive them; the tokens, lines and
+// positions are the same as Lexer's.
+class BufferLexer {
+public:
+    BufferLexer(const char* data, size_t size);
+
+    // Get next token (INVALID at the end of the buffer or on a bad character)
+    TokenView getNextToken();
+
+    // Get the text of a token
+    std::string_view text(const TokenView& token) const {
+        return std::string_view(begin + token.offset, token.length);
+    }
+
+private:
+    const char* begin;
+    const char* cursor;
+    const char* end;
+    int line;
+    int position;
+    const ScanKernels* kernels;
+
+    TokenView makeToken(TokenType type, const char* start, const char* stop);
+};
+
+// Function to scan a whole buffer into tokens, stopping at the first INVALID one
+std::vector<TokenView> scanTokens(const char* data, size_t size);
+
 #endif // FUNCTIONS_H
 
 #ifndef GLOBALS_H
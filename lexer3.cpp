@@ -3,7 +3,16 @@
 #include <string>
 #include <vector>
 #include <cctype>
+#include <array>
+#include <cstdint>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
 #include "token.h"
+#include "lexer.h"
 using namespace std;
 
 
@@ -183,6 +192,342 @@ private:
     }
 };
 
+// Character classes of the table-driven scanner
+enum CharClass : uint8_t {
+    CC_OTHER,
+    CC_SPACE,       // isspace, including newline
+    CC_DIGIT,
+    CC_ALPHA,
+    CC_DELIMITER,
+    CC_OPERATOR,
+    CC_QUOTE,       // ' and "
+};
+
+// Function to build the character class table (C locale, as used by Lexer)
+static array<uint8_t, 256> buildCharClasses() {
+    array<uint8_t, 256> classes;
+    for (int c = 0; c < 256; ++c) {
+        if (isspace(c))
+            classes[c] = CC_SPACE;
+        else if (isdigit(c))
+            classes[c] = CC_DIGIT;
+        else if (isalpha(c))
+            classes[c] = CC_ALPHA;
+        else if (c == ';' || c == '(' || c == ')' || c == '{' || c == '}')
+            classes[c] = CC_DELIMITER;
+        else if (c == '+' || c == '-' || c == '*' || c == '^' || c == '=' || c == '<' || c == '>')
+            classes[c] = CC_OPERATOR;
+        else if (c == '\'' || c == '"')
+            classes[c] = CC_QUOTE;
+        else
+            classes[c] = CC_OTHER;
+    }
+    return classes;
+}
+
+static const array<uint8_t, 256> charClasses = buildCharClasses();
+
+// Scalar kernels: each returns the first byte in [p, end) that ends the run.
+// skipWhitespace also counts the newlines in the run and remembers the last one.
+static const char* skipWhitespaceScalar(const char* p, const char* end, int& newlines, const char*& lastNewline) {
+    for (; p < end && charClasses[(unsigned char)*p] == CC_SPACE; ++p) {
+        if (*p == '\n') {
+            newlines++;
+            lastNewline = p;
+        }
+    }
+    return p;
+}
+
+static const char* skipIdentifierScalar(const char* p, const char* end) {
+    while (p < end && (isalnum((unsigned char)*p) || *p == '_'))
+        ++p;
+    return p;
+}
+
+static const char* skipDigitsScalar(const char* p, const char* end) {
+    while (p < end && charClasses[(unsigned char)*p] == CC_DIGIT)
+        ++p;
+    return p;
+}
+
+static const char* findByteScalar(const char* p, const char* end, char byte) {
+    while (p < end && *p != byte)
+        ++p;
+    return p;
+}
+
+#if defined(__SSE2__)
+// SSE2 kernels, 16 bytes per step. A byte is in [low, low + count) when
+// min(x - low, count - 1) == x - low (unsigned).
+static inline __m128i inRange128(__m128i x, char low, char count) {
+    __m128i offset = _mm_sub_epi8(x, _mm_set1_epi8(low));
+    return _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(count - 1)), offset);
+}
+
+static inline __m128i identifierMask128(__m128i x) {
+    __m128i letter = inRange128(_mm_or_si128(x, _mm_set1_epi8(0x20)), 'a', 26);
+    __m128i digit = inRange128(x, '0', 10);
+    __m128i underscore = _mm_cmpeq_epi8(x, _mm_set1_epi8('_'));
+    return _mm_or_si128(_mm_or_si128(letter, digit), underscore);
+}
+
+static const char* skipWhitespaceSSE2(const char* p, const char* end, int& newlines, const char*& lastNewline) {
+    for (; end - p >= 16; p += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i space = _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(' ')), inRange128(x, '\t', 5));
+        uint32_t stop = ~_mm_movemask_epi8(space) & 0xFFFF;
+        uint32_t run = stop ? (stop & -stop) - 1 : 0xFFFF;  // Bytes before the first non-space
+        uint32_t lines = _mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_set1_epi8('\n'))) & run;
+        if (lines) {
+            newlines += __builtin_popcount(lines);
+            lastNewline = p + 31 - __builtin_clz(lines);
+        }
+        if (stop)
+            return p + __builtin_ctz(stop);
+    }
+    return skipWhitespaceScalar(p, end, newlines, lastNewline);
+}
+
+static const char* skipIdentifierSSE2(const char* p, const char* end) {
+    for (; end - p >= 16; p += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        uint32_t stop = ~_mm_movemask_epi8(identifierMask128(x)) & 0xFFFF;
+        if (stop)
+            return p + __builtin_ctz(stop);
+    }
+    return skipIdentifierScalar(p, end);
+}
+
+static const char* skipDigitsSSE2(const char* p, const char* end) {
+    for (; end - p >= 16; p += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        uint32_t stop = ~_mm_movemask_epi8(inRange128(x, '0', 10)) & 0xFFFF;
+        if (stop)
+            return p + __builtin_ctz(stop);
+    }
+    return skipDigitsScalar(p, end);
+}
+
+static const char* findByteSSE2(const char* p, const char* end, char byte) {
+    __m128i target = _mm_set1_epi8(byte);
+    for (; end - p >= 16; p += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        uint32_t found = _mm_movemask_epi8(_mm_cmpeq_epi8(x, target));
+        if (found)
+            return p + __builtin_ctz(found);
+    }
+    return findByteScalar(p, end, byte);
+}
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_AVX2_KERNELS 1
+// AVX2 kernels, 32 bytes per step; only called when the CPU supports AVX2
+__attribute__((target("avx2")))
+static inline __m256i inRange256(__m256i x, char low, char count) {
+    __m256i offset = _mm256_sub_epi8(x, _mm256_set1_epi8(low));
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8(count - 1)), offset);
+}
+
+__attribute__((target("avx2")))
+static const char* skipWhitespaceAVX2(const char* p, const char* end, int& newlines, const char*& lastNewline) {
+    for (; end - p >= 32; p += 32) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i space = _mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8(' ')), inRange256(x, '\t', 5));
+        uint32_t stop = ~uint32_t(_mm256_movemask_epi8(space));
+        uint32_t run = stop ? (stop & -stop) - 1 : 0xFFFFFFFF;
+        uint32_t lines = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('\n')))) & run;
+        if (lines) {
+            newlines += __builtin_popcount(lines);
+            lastNewline = p + 31 - __builtin_clz(lines);
+        }
+        if (stop)
+            return p + __builtin_ctz(stop);
+    }
+    return skipWhitespaceScalar(p, end, newlines, lastNewline);
+}
+
+__attribute__((target("avx2")))
+static const char* skipIdentifierAVX2(const char* p, const char* end) {
+    for (; end - p >= 32; p += 32) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i letter = inRange256(_mm256_or_si256(x, _mm256_set1_epi8(0x20)), 'a', 26);
+        __m256i digit = inRange256(x, '0', 10);
+        __m256i underscore = _mm256_cmpeq_epi8(x, _mm256_set1_epi8('_'));
+        __m256i identifier = _mm256_or_si256(_mm256_or_si256(letter, digit), underscore);
+        uint32_t stop = ~uint32_t(_mm256_movemask_epi8(identifier));
+        if (stop)
+            return p + __builtin_ctz(stop);
+    }
+    return skipIdentifierScalar(p, end);
+}
+
+__attribute__((target("avx2")))
+static const char* skipDigitsAVX2(const char* p, const char* end) {
+    for (; end - p >= 32; p += 32) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        uint32_t stop = ~uint32_t(_mm256_movemask_epi8(inRange256(x, '0', 10)));
+        if (stop)
+            return p + __builtin_ctz(stop);
+    }
+    return skipDigitsScalar(p, end);
+}
+
+__attribute__((target("avx2")))
+static const char* findByteAVX2(const char* p, const char* end, char byte) {
+    __m256i target = _mm256_set1_epi8(byte);
+    for (; end - p >= 32; p += 32) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        uint32_t found = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, target)));
+        if (found)
+            return p + __builtin_ctz(found);
+    }
+    return findByteScalar(p, end, byte);
+}
+#endif
+
+static const ScanKernels scalarKernels = {
+    "scalar", skipWhitespaceScalar, skipIdentifierScalar, skipDigitsScalar, findByteScalar};
+#if defined(__SSE2__)
+static const ScanKernels sse2Kernels = {
+    "sse2", skipWhitespaceSSE2, skipIdentifierSSE2, skipDigitsSSE2, findByteSSE2};
+#endif
+#if defined(HAVE_AVX2_KERNELS)
+static const ScanKernels avx2Kernels = {
+    "avx2", skipWhitespaceAVX2, skipIdentifierAVX2, skipDigitsAVX2, findByteAVX2};
+#endif
+
+// Function to pick the widest kernels the CPU supports
+static const ScanKernels* detectScanKernels() {
+#if defined(HAVE_AVX2_KERNELS)
+    if (__builtin_cpu_supports("avx2"))
+        return &avx2Kernels;
+#endif
+#if defined(__SSE2__)
+    return &sse2Kernels;
+#else
+    return &scalarKernels;
+#endif
+}
+
+static const ScanKernels* activeScanKernels = detectScanKernels();
+
+bool selectScanKernels(const string& name) {
+    if (name == "auto") {
+        activeScanKernels = detectScanKernels();
+        return true;
+    }
+    if (name == "scalar") {
+        activeScanKernels = &scalarKernels;
+        return true;
+    }
+#if defined(__SSE2__)
+    if (name == "sse2") {
+        activeScanKernels = &sse2Kernels;
+        return true;
+    }
+#endif
+#if defined(HAVE_AVX2_KERNELS)
+    if (name == "avx2" && __builtin_cpu_supports("avx2")) {
+        activeScanKernels = &avx2Kernels;
+        return true;
+    }
+#endif
+    return false;
+}
+
+const char* scanKernelsName() {
+    return activeScanKernels->name;
+}
+
+BufferLexer::BufferLexer(const char* data, size_t size)
+    : begin(data), cursor(data), end(data + size), line(1), position(1), kernels(activeScanKernels) {}
+
+// Create a token for the text [start, stop), positioned like Lexer's tokens
+TokenView BufferLexer::makeToken(TokenType type, const char* start, const char* stop) {
+    uint32_t length = stop - start;
+    return {type, uint32_t(start - begin), length, line, int(position - length)};
+}
+
+// Check if the text is one of the language keywords
+static bool isKeyword(const char* text, size_t length) {
+    static const string keywords[] = {"void", "main", "int", "char", "string", "if", "else", "for"};
+    for (const string& keyword : keywords) {
+        if (keyword.size() == length && keyword.compare(0, length, text, length) == 0)
+            return true;
+    }
+    return false;
+}
+
+// Get next token. The first character's class selects the token kind, and the
+// rest of a whitespace run, identifier, integer or literal body is skipped by
+// the scan kernels. Lines and positions are counted exactly as in Lexer,
+// including its quirks: the closing quote of a literal does not advance the
+// position, and newlines inside literals are not counted.
+TokenView BufferLexer::getNextToken() {
+    while (cursor < end) {
+        const char* start = cursor;
+        switch (charClasses[(unsigned char)*cursor]) {
+            case CC_SPACE: {
+                int newlines = 0;
+                const char* lastNewline = nullptr;
+                cursor = kernels->skipWhitespace(cursor, end, newlines, lastNewline);
+                if (newlines == 0) {
+                    position += cursor - start;
+                } else {
+                    line += newlines;
+                    position = cursor - lastNewline;
+                }
+                continue;
+            }
+            case CC_DIGIT:
+                cursor = kernels->skipDigits(cursor + 1, end);
+                position += cursor - start;
+                return makeToken(INTEGER_LITERAL, start, cursor);
+            case CC_ALPHA:
+                cursor = kernels->skipIdentifier(cursor + 1, end);
+                position += cursor - start;
+                return makeToken(isKeyword(start, cursor - start) ? KEYWORD : IDENTIFIER, start, cursor);
+            case CC_DELIMITER:
+                ++cursor;
+                position++;
+                return makeToken(DELIMITER, start, cursor);
+            case CC_OPERATOR:
+                ++cursor;
+                position++;
+                return makeToken(OPERATOR, start, cursor);
+            case CC_QUOTE: {
+                // The token text is the literal body, without the quotes
+                char quote = *cursor++;
+                position++;
+                const char* body = cursor;
+                cursor = kernels->findByte(cursor, end, quote);
+                position += cursor - body;
+                TokenView token = makeToken(quote == '"' ? STRING_LITERAL : CHAR_LITERAL, body, cursor);
+                if (cursor < end)
+                    ++cursor; // Skip the closing quote
+                return token;
+            }
+            default:
+                ++cursor;
+                position++;
+                return {INVALID, uint32_t(start - begin), 1, line, position};
+        }
+    }
+    return {INVALID, uint32_t(end - begin), 0, line, position};
+}
+
+vector<TokenView> scanTokens(const char* data, size_t size) {
+    vector<TokenView> tokens;
+    tokens.reserve(size / 4);
+    BufferLexer lexer(data, size);
+    for (TokenView token = lexer.getNextToken(); token.type != INVALID; token = lexer.getNextToken()) {
+        tokens.push_back(token);
+    }
+    return tokens;
+}
+
 // Function to generate tokens and add them to the Symbol Table
 vector<string> getTokens(string filename){
     vector<string>tokens;
@@ -0,0 +1,61 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+    #include <string>
+    #include <cstddef>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+    // Read-only memory mapping of a whole file
+    class MappedFile {
+    public:
+        MappedFile() {}
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile() {
+            close();
+        }
+
+        // Map a file; returns false if it cannot be opened or mapped.
+        // An empty file maps to an empty buffer.
+        bool open(const std::string& filename) {
+            close();
+            int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd < 0)
+                return false;
+            struct stat info;
+            if (fstat(fd, &info) != 0) {
+                ::close(fd);
+                return false;
+            }
+            length = info.st_size;
+            if (length > 0) {
+                void* memory = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+                if (memory == MAP_FAILED) {
+                    ::close(fd);
+                    length = 0;
+                    return false;
+                }
+                mapping = static_cast<const char*>(memory);
+            }
+            ::close(fd);
+            return true;
+        }
+
+        void close() {
+            if (mapping != nullptr)
+                munmap(const_cast<char*>(mapping), length);
+            mapping = nullptr;
+            length = 0;
+        }
+
+        const char* data() const { return mapping; }
+        size_t size() const { return length; }
+
+    private:
+        const char* mapping = nullptr;
+        size_t length = 0;
+    };
+#endif
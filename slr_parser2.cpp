@@ -9,30 +9,45 @@
 #include <queue>
 #include <stack>
 #include <iomanip>
+#include <unordered_map>
+#include <cstdint>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "lexer.h"
 #include "token.h"
+#include "mapped_file.h"
 
 using namespace std;
 
+// Grammar symbols are interned as dense integer IDs once the grammar is read.
+// Terminals take IDs 0..T-1 in sorted order, "$" takes T and non-terminals
+// take T+1..T+N, so the ID of a symbol is also its column in the parsing table.
+typedef uint32_t SymbolId;
+const SymbolId NO_SYMBOL = UINT32_MAX;     // No symbol (dot at the end, unknown token)
+const SymbolId EPSILON = UINT32_MAX - 1;   // Stands for "#" inside FIRST sets
+
 // Class to represent an LR item
 struct LR0Item {
-    string lhs;       // Left-hand side of the production
-    vector<string> rhs;       // Right-hand side of the production
+    SymbolId lhs;             // Left-hand side of the production
+    vector<SymbolId> rhs;     // Right-hand side of the production (empty for "#")
     int dotPosition;  // Position of the dot in the right-hand side
 
-    LR0Item(const string& l, const vector<string>& r, int pos) : lhs(l), rhs(r), dotPosition(pos) {}
+    LR0Item(SymbolId l, const vector<SymbolId>& r, int pos) : lhs(l), rhs(r), dotPosition(pos) {}
 
     // Function to check if the item is complete (dot is at the end)
     bool isComplete() const {
         return dotPosition == rhs.size();
     }
 
-    // Function to get the symbol after the dot (returns empty string if dot is at the end)
-    string getNextSymbol() const {
+    // Function to get the symbol after the dot (returns NO_SYMBOL if dot is at the end)
+    SymbolId getNextSymbol() const {
         if (dotPosition < rhs.size())
             return rhs[dotPosition];
         else
-            return "";
+            return NO_SYMBOL;
     }
 
     // Comparison operator for LR0Item
@@ -42,12 +57,8 @@ struct LR0Item {
             return lhs < other.lhs;
 
         // Then compare rhs
-        if (rhs.size() != other.rhs.size())
-            return rhs.size() < other.rhs.size();
-        for (size_t i = 0; i < rhs.size(); ++i) {
-            if (rhs[i] != other.rhs[i])
-                return rhs[i] < other.rhs[i];
-        }
+        if (rhs != other.rhs)
+            return rhs < other.rhs;
 
         // Finally, compare dotPosition
         return dotPosition < other.dotPosition;
@@ -58,13 +69,73 @@ struct LR0Item {
     }
 };
 
+// Hash functor for item-set kernels, used to find existing states in O(1)
+struct ItemSetHash {
+    size_t operator()(const vector<LR0Item>& kernel) const {
+        size_t hash = kernel.size();
+        for (const LR0Item& item : kernel) {
+            hash = hash * 1000003 ^ item.lhs;
+            hash = hash * 1000003 ^ item.dotPosition;
+            for (SymbolId symbol : item.rhs) {
+                hash = hash * 31 + symbol;
+            }
+        }
+        return hash;
+    }
+};
+
+// Class to represent a set of terminals (and "$") as a packed bitset over symbol IDs
+class TerminalSet {
+public:
+    vector<uint64_t> words;
+
+    TerminalSet(size_t size = 0) : words((size + 63) / 64, 0) {}
+
+    // Add a terminal, returns true if it was not in the set yet
+    bool insert(SymbolId terminal) {
+        uint64_t bit = uint64_t(1) << (terminal % 64);
+        uint64_t& word = words[terminal / 64];
+        bool added = !(word & bit);
+        word |= bit;
+        return added;
+    }
+
+    bool contains(SymbolId terminal) const {
+        return (words[terminal / 64] >> (terminal % 64)) & 1;
+    }
+
+    // Add all terminals of another set of the same size, returns true if any was new
+    bool unionWith(const TerminalSet& other) {
+        uint64_t added = 0;
+        for (size_t i = 0; i < words.size(); ++i) {
+            added |= other.words[i] & ~words[i];
+            words[i] |= other.words[i];
+        }
+        return added != 0;
+    }
+
+    void clear() {
+        fill(words.begin(), words.end(), 0);
+    }
+
+    // Call f for every terminal in the set, in ID order
+    template <typename F>
+    void forEach(F f) const {
+        for (size_t i = 0; i < words.size(); ++i) {
+            for (uint64_t word = words[i]; word != 0; word &= word - 1) {
+                f(SymbolId(i * 64 + __builtin_ctzll(word)));
+            }
+        }
+    }
+};
+
 // Class to represent a production
 class Production {
 public:
-    string left;            // Left-hand side of the production
-    vector<string> right;   // Right-hand side of the production
+    SymbolId left;            // Left-hand side of the production
+    vector<SymbolId> right;   // Right-hand side of the production (empty for "#")
 
-    Production(const string& l, const vector<string>& r) : left(l), right(r) {}
+    Production(SymbolId l, const vector<SymbolId>& r) : left(l), right(r) {}
 };
 
 // Define ActionType enum
@@ -82,133 +153,457 @@ struct Action {
     int value; // For SHIFT and GOTO: state index; For REDUCE: production index
 };
 
+// Class to represent a parsing table in compressed form.
+// Identical rows are shared, and the rows are overlaid in one array with
+// row displacement: the action of (state, symbol) sits at base[state] + symbol
+// if the check entry of that slot holds the same base, otherwise it is ERROR.
+// Distinct rows get distinct bases, so the base itself identifies the owner.
+// Actions are packed into 16 bits (3-bit type, 13-bit value) when every state
+// and production index fits, and 32 bits otherwise. The base, check and action
+// arrays live in a single allocation.
+class CompactParsingTable {
+public:
+    // Sizes and word offsets of the arrays; written as-is into table artifacts
+    struct Layout {
+        uint32_t numStates = 0;
+        uint32_t numColumns = 0;
+        uint32_t numUniqueRows = 0;
+        uint32_t numSlots = 0;
+        uint32_t checkOffset = 0;   // The base array starts at word 0
+        uint32_t cellOffset = 0;
+        uint32_t totalWords = 0;
+        uint32_t wideCells = 0;     // 1 for 32-bit actions, 0 for 16-bit
+        uint32_t valueBits = 13;
+    };
+    Layout layout;
+
+    CompactParsingTable() {}
+
+    // Create a table that reads its arrays from memory owned by someone else,
+    // such as a mapped table artifact
+    CompactParsingTable(const Layout& l, const uint32_t* data) : layout(l), words(data) {}
+
+    CompactParsingTable(CompactParsingTable&&) = default;
+    CompactParsingTable& operator=(CompactParsingTable&&) = default;
+    CompactParsingTable(const CompactParsingTable&) = delete;
+    CompactParsingTable& operator=(const CompactParsingTable&) = delete;
+
+    explicit CompactParsingTable(const vector<vector<Action>>& dense) {
+        layout.numStates = dense.size();
+        layout.numColumns = dense.empty() ? 0 : dense[0].size();
+
+        int maxValue = 0;
+        for (const auto& row : dense) {
+            for (const Action& action : row) {
+                maxValue = max(maxValue, action.value);
+            }
+        }
+        layout.wideCells = maxValue + 1 >= (1 << 13);
+        layout.valueBits = layout.wideCells ? 29 : 13;
+
+        // Share identical rows
+        map<vector<uint32_t>, int> rowIds;
+        vector<vector<uint32_t>> rows;
+        vector<int> rowOfState(layout.numStates);
+        for (size_t state = 0; state < layout.numStates; ++state) {
+            vector<uint32_t> row(layout.numColumns);
+            for (size_t column = 0; column < layout.numColumns; ++column) {
+                row[column] = encode(dense[state][column]);
+            }
+            auto inserted = rowIds.emplace(row, rows.size());
+            if (inserted.second)
+                rows.push_back(row);
+            rowOfState[state] = inserted.first->second;
+        }
+        layout.numUniqueRows = rows.size();
+
+        // Place the rows, densest first, at the lowest base where their non-error
+        // entries only fall on free slots
+        vector<int> order(rows.size());
+        vector<vector<uint32_t>> entries(rows.size()); // Non-error columns of each row
+        for (size_t r = 0; r < rows.size(); ++r) {
+            order[r] = r;
+            for (size_t column = 0; column < layout.numColumns; ++column) {
+                if (rows[r][column] != errorCell())
+                    entries[r].push_back(column);
+            }
+        }
+        stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            return entries[a].size() > entries[b].size();
+        });
+        // Used slots and used bases are bitsets, so 64 candidate bases are tested at once.
+        // Slots only ever fill up, so a row with the same columns as an earlier row
+        // cannot fit below that row's base and the search starts just after it.
+        vector<uint64_t> slotUsed, baseUsed;
+        vector<uint32_t> rowBase(rows.size());
+        map<vector<uint32_t>, size_t> patternNextBase;
+        size_t firstFreeWord = 0, maxBase = 0;
+        for (int r : order) {
+            const vector<uint32_t>& columns = entries[r];
+            while (firstFreeWord < slotUsed.size() && slotUsed[firstFreeWord] == ~uint64_t(0))
+                ++firstFreeWord;
+            size_t firstFree = firstFreeWord * 64;
+            size_t candidate = columns.empty() || columns[0] > firstFree ? 0 : firstFree - columns[0];
+            size_t& patternBase = patternNextBase[columns];
+            candidate = max(candidate, patternBase);
+            while (true) {
+                uint64_t conflicts = bitWindow(baseUsed, candidate);
+                for (size_t i = 0; conflicts != ~uint64_t(0) && i < columns.size(); ++i) {
+                    conflicts |= bitWindow(slotUsed, candidate + columns[i]);
+                }
+                if (conflicts != ~uint64_t(0)) {
+                    candidate += __builtin_ctzll(~conflicts);
+                    break;
+                }
+                candidate += 64;
+            }
+            rowBase[r] = candidate;
+            patternBase = candidate + 1;
+            maxBase = max(maxBase, candidate);
+            setBit(baseUsed, candidate);
+            for (uint32_t column : columns) {
+                setBit(slotUsed, candidate + column);
+            }
+        }
+        layout.numSlots = maxBase + layout.numColumns;
+
+        // Lay out base | check | cells in one buffer
+        size_t cellWords = layout.wideCells ? layout.numSlots : (layout.numSlots + 1) / 2;
+        layout.checkOffset = layout.numStates;
+        layout.cellOffset = layout.checkOffset + layout.numSlots;
+        layout.totalWords = layout.cellOffset + cellWords;
+        storage.assign(layout.totalWords, 0);
+        fill(storage.begin() + layout.checkOffset, storage.begin() + layout.cellOffset, NO_BASE);
+        for (size_t state = 0; state < layout.numStates; ++state) {
+            storage[state] = rowBase[rowOfState[state]];
+        }
+        for (size_t r = 0; r < rows.size(); ++r) {
+            for (uint32_t column : entries[r]) {
+                size_t slot = rowBase[r] + column;
+                storage[layout.checkOffset + slot] = rowBase[r];
+                if (layout.wideCells)
+                    storage[layout.cellOffset + slot] = rows[r][column];
+                else
+                    reinterpret_cast<uint16_t*>(&storage[layout.cellOffset])[slot] = rows[r][column];
+            }
+        }
+        words = storage.data();
+    }
+
+    // Get the action for a state and a symbol (column) ID. Every base + column
+    // is inside the arrays, so the cell is read unconditionally and replaced by
+    // ERROR without a branch when the check entry belongs to another row.
+    Action lookup(int state, uint32_t symbol) const {
+        const uint32_t* data = words;
+        uint32_t base = data[state];
+        uint32_t slot = base + symbol;
+        uint32_t cell = layout.wideCells ? data[layout.cellOffset + slot]
+                                  : reinterpret_cast<const uint16_t*>(data + layout.cellOffset)[slot];
+        cell = data[layout.checkOffset + slot] == base ? cell : errorCell();
+        return {ActionType(cell >> layout.valueBits), int(cell & ((1u << layout.valueBits) - 1)) - 1};
+    }
+
+    // Size of the compressed table in bytes
+    size_t bytes() const {
+        return size_t(layout.totalWords) * sizeof(uint32_t);
+    }
+
+    // The base, check and action arrays as one block of layout.totalWords words
+    const uint32_t* data() const {
+        return words;
+    }
+
+    // Size in bytes of the equivalent vector<vector<Action>> table
+    static size_t denseBytes(const vector<vector<Action>>& dense) {
+        size_t total = sizeof(dense) + dense.size() * sizeof(vector<Action>);
+        for (const auto& row : dense) {
+            total += row.size() * sizeof(Action);
+        }
+        return total;
+    }
+
+private:
+    static const uint32_t NO_BASE = UINT32_MAX;
+    vector<uint32_t> storage;       // Empty when the arrays are external
+    const uint32_t* words = nullptr;
+
+    // Get the 64 bits starting at bit pos (bits past the end read as 0)
+    static uint64_t bitWindow(const vector<uint64_t>& bits, size_t pos) {
+        size_t word = pos / 64, shift = pos % 64;
+        uint64_t low = word < bits.size() ? bits[word] >> shift : 0;
+        uint64_t high = shift != 0 && word + 1 < bits.size() ? bits[word + 1] << (64 - shift) : 0;
+        return low | high;
+    }
+
+    static void setBit(vector<uint64_t>& bits, size_t pos) {
+        if (pos / 64 >= bits.size())
+            bits.resize(pos / 64 + 1, 0);
+        bits[pos / 64] |= uint64_t(1) << (pos % 64);
+    }
+
+    // Pack an action as type | value + 1 (so the -1 of ERROR and ACCEPT becomes 0)
+    uint32_t encode(const Action& action) const {
+        return (uint32_t(action.type) << layout.valueBits) | uint32_t(action.value + 1);
+    }
+
+    uint32_t errorCell() const {
+        return encode({ActionType::ERROR, -1});
+    }
+};
+
+// Functions to look up an action in either table representation
+inline Action lookupAction(const vector<vector<Action>>& table, int state, uint32_t symbol) {
+    return table[state][symbol];
+}
+
+inline Action lookupAction(const CompactParsingTable& table, int state, uint32_t symbol) {
+    return table.lookup(state, symbol);
+}
+
 // Class to represent a grammar
 class Grammar {
 public:
     set<string> terminals;
     set<string> nonTerminals;
     string startSymbol;
+    vector<pair<string, vector<string>>> productionText; // Productions as read, before interning
+    vector<string> symbolNames;                // Symbol ID -> name
+    unordered_map<string, SymbolId> symbolIds; // Name -> symbol ID
+    size_t numTerminals = 0;
+    SymbolId endMarker = NO_SYMBOL;            // ID of "$"
+    SymbolId startId = NO_SYMBOL;              // ID of the start symbol
     vector<Production> productions;
     vector<vector<LR0Item>> automaton; // Vector of LR(0) item sets
-    map<pair<int, string>, int> transitions; // Map to store transitions
-    map<string, set<string>> firstSets;
-    map<string, set<string>> followSets;
+    unordered_map<vector<LR0Item>, int, ItemSetHash> stateIndex; // Sorted kernel -> state index
+    map<pair<int, SymbolId>, int> transitions; // Map to store transitions
+    vector<bool> nullable;             // Indexed by symbol ID
+    vector<TerminalSet> firstSets;     // Indexed by symbol ID, "#" is kept in nullable
+    vector<TerminalSet> followSets;    // Indexed by symbol ID
 
 
     // Function to add transitions between LR(0) item sets
-    void addTransition(int fromState, const string& symbol, int toState) {
+    void addTransition(int fromState, SymbolId symbol, int toState) {
         transitions[{fromState, symbol}] = toState;
     }
 
-    // Add a production to the grammar
+    // Add a production to the grammar (its symbols get IDs in internSymbols)
     void addProduction(const string& left, const vector<string>& right) {
-        productions.emplace_back(left, right);
+        productionText.emplace_back(left, right);
         nonTerminals.insert(left);
         for (const string& symbol : right) {
             if (isTerminal(symbol))
                 terminals.insert(symbol);
+            else if (symbol != "#")
+                nonTerminals.insert(symbol);
         }
         
     }
 
+    // Function to assign symbol IDs and convert the productions to ID form
+    void internSymbols() {
+        symbolNames.clear();
+        symbolIds.clear();
+        for (const string& terminal : terminals) {
+            symbolIds.emplace(terminal, symbolNames.size());
+            symbolNames.push_back(terminal);
+        }
+        numTerminals = terminals.size();
+        endMarker = symbolNames.size();
+        symbolIds.emplace("$", endMarker);
+        symbolNames.push_back("$");
+        for (const string& nonTerminal : nonTerminals) {
+            symbolIds.emplace(nonTerminal, symbolNames.size());
+            symbolNames.push_back(nonTerminal);
+        }
+        startId = getSymbolId(startSymbol);
+
+        productions.clear();
+        for (const auto& text : productionText) {
+            vector<SymbolId> right;
+            for (const string& symbol : text.second) {
+                if (symbol != "#")
+                    right.push_back(getSymbolId(symbol));
+            }
+            productions.emplace_back(getSymbolId(text.first), right);
+        }
+    }
+
+    // Get the ID of a symbol (NO_SYMBOL if the grammar does not use it)
+    SymbolId getSymbolId(const string& symbol) const {
+        auto it = symbolIds.find(symbol);
+        return it == symbolIds.end() ? NO_SYMBOL : it->second;
+    }
+
+    // Get the printable name of a symbol
+    const string& symbolName(SymbolId symbol) const {
+        static const string epsilon = "#";
+        return symbol == EPSILON ? epsilon : symbolNames[symbol];
+    }
+
     // Check if a symbol is a non-terminal
-    bool isNonTerminal(const string& symbol) const {
-        return nonTerminals.find(symbol) != nonTerminals.end();
+    bool isNonTerminal(SymbolId symbol) const {
+        return symbol > endMarker && symbol < symbolNames.size();
     }
 
     // Check if a symbol is a terminal
+    bool isTerminal(SymbolId symbol) const {
+        return symbol < numTerminals;
+    }
+
+    // Check if a symbol name denotes a terminal
     bool isTerminal(const string& symbol) const {
         return symbol != "#" && !isupper(symbol[0]); 
     }
 
-    void computeFirstSets() {
-        bool updated = true;
-        while (updated) {
-            updated = false;
-            for (const Production& production : productions) {
-                const string& left = production.left;
-                const vector<string>& right = production.right;
-
-                bool allDeriveEpsilon = true;
-                for (const string& symbol : right) {
-                    if(symbol == "#"){
-                        allDeriveEpsilon = true;
-                    }
-                    else if (isTerminal(symbol)) {
-                        updated |= firstSets[left].insert(symbol).second;
-                        allDeriveEpsilon = false;
-                        break;
-                    } else {
-                        for (const string& s : firstSets[symbol]) {
-                            if (s != "#") {
-                                updated |= firstSets[left].insert(s).second;
-                            }
-                        }
-                        if (!firstSets[symbol].count("#")) {
-                            allDeriveEpsilon = false;
-                            break;
-                        }
-                    }
+    // Function to print a right-hand side ("#" for an empty one)
+    void printSymbols(const vector<SymbolId>& symbols) const {
+        if (symbols.empty())
+            cout << "# ";
+        for (SymbolId symbol : symbols) {
+            cout << symbolName(symbol) << " ";
+        }
+    }
+
+    // Function to compute which non-terminals derive the empty string.
+    // Every production keeps a count of right-hand side symbols not yet known to be
+    // nullable; when a non-terminal becomes nullable the counts of the productions
+    // that use it are decremented, so each production is revisited only then.
+    void computeNullable() {
+        nullable.assign(symbolNames.size(), false);
+        vector<int> remaining(productions.size());
+        vector<vector<int>> users(symbolNames.size()); // Productions using each symbol, once per occurrence
+        vector<SymbolId> worklist;
+        for (size_t i = 0; i < productions.size(); ++i) {
+            const Production& production = productions[i];
+            bool hasTerminal = false;
+            for (SymbolId symbol : production.right) {
+                hasTerminal |= isTerminal(symbol);
+            }
+            if (hasTerminal)
+                continue; // Can never derive the empty string
+            remaining[i] = production.right.size();
+            for (SymbolId symbol : production.right) {
+                users[symbol].push_back(i);
+            }
+            if (remaining[i] == 0 && !nullable[production.left]) {
+                nullable[production.left] = true;
+                worklist.push_back(production.left);
+            }
+        }
+        while (!worklist.empty()) {
+            SymbolId symbol = worklist.back();
+            worklist.pop_back();
+            for (int i : users[symbol]) {
+                SymbolId left = productions[i].left;
+                if (--remaining[i] == 0 && !nullable[left]) {
+                    nullable[left] = true;
+                    worklist.push_back(left);
                 }
-                if (allDeriveEpsilon) {
-                    updated |= firstSets[left].insert("#").second;
+            }
+        }
+    }
+
+    // Function to propagate sets along dependency edges until nothing changes.
+    // dependents[X] lists the symbols whose set includes the set of X; a symbol is
+    // put back on the worklist only when its own set grows.
+    void propagateSets(vector<TerminalSet>& sets, const vector<vector<SymbolId>>& dependents) {
+        vector<SymbolId> worklist;
+        vector<bool> queued(symbolNames.size(), false);
+        for (SymbolId nonTerminal = endMarker + 1; nonTerminal < symbolNames.size(); ++nonTerminal) {
+            worklist.push_back(nonTerminal);
+            queued[nonTerminal] = true;
+        }
+        while (!worklist.empty()) {
+            SymbolId symbol = worklist.back();
+            worklist.pop_back();
+            queued[symbol] = false;
+            for (SymbolId dependent : dependents[symbol]) {
+                if (sets[dependent].unionWith(sets[symbol]) && !queued[dependent]) {
+                    queued[dependent] = true;
+                    worklist.push_back(dependent);
                 }
             }
         }
     }
 
+    // Function to compute the nullable set and the FIRST sets.
+    // FIRST(A) includes FIRST(B) for every production A -> x B y with x nullable.
+    void computeFirstSets() {
+        computeNullable();
+        firstSets.assign(symbolNames.size(), TerminalSet(endMarker + 1));
+        vector<vector<SymbolId>> dependents(symbolNames.size());
+        for (const Production& production : productions) {
+            for (SymbolId symbol : production.right) {
+                if (isTerminal(symbol)) {
+                    firstSets[production.left].insert(symbol);
+                    break;
+                }
+                if (symbol != production.left)
+                    dependents[symbol].push_back(production.left);
+                if (!nullable[symbol])
+                    break;
+            }
+        }
+        propagateSets(firstSets, dependents);
+    }
+
 
     
 
-    // Function to compute follow sets
+    // Function to compute follow sets.
+    // For A -> x B y, FOLLOW(B) gets FIRST(y), and also FOLLOW(A) when y is nullable.
 void computeFollowSets() {
-    followSets[startSymbol].insert("$");
-    bool updated = true;
-    while (updated) {
-        updated = false;
-        for (const Production& production : productions) {
-            const string& left = production.left;
-            const vector<string>& right = production.right;
-
-            for (size_t i = 0; i < right.size(); ++i) {
-                const string& symbol = right[i];
-                if (isNonTerminal(symbol)) {
-                    bool allDeriveEpsilon = true;
-                    for (size_t j = i + 1; j < right.size(); ++j) {
-                        const string& nextSymbol = right[j];
-                        if (isTerminal(nextSymbol)) {
-                            updated |= followSets[symbol].insert(nextSymbol).second;
-                            allDeriveEpsilon = false;
-                            break;
-                        } else if(isNonTerminal(nextSymbol)) {
-                            for (const string& s : firstSets[nextSymbol]) {
-                                if (s != "#") {
-                                    updated |= followSets[symbol].insert(s).second;
-                                }
-                            }
-                            if (!firstSets[nextSymbol].count("#")) {
-                                allDeriveEpsilon = false;
-                                break;
-                            }
-                        }
-                    }
-                    if (allDeriveEpsilon) {
-                        for (const string& f : followSets[left]) {
-                            updated |= followSets[symbol].insert(f).second;
-                        }
-                    }
-                }
+    followSets.assign(symbolNames.size(), TerminalSet(endMarker + 1));
+    followSets[startId].insert(endMarker);
+    vector<vector<SymbolId>> dependents(symbolNames.size());
+    TerminalSet suffixFirst(endMarker + 1);
+    for (const Production& production : productions) {
+        SymbolId left = production.left;
+        const vector<SymbolId>& right = production.right;
+
+        // Walk the right-hand side backwards, carrying FIRST of the suffix
+        suffixFirst.clear();
+        bool suffixNullable = true;
+        for (size_t i = right.size(); i-- > 0;) {
+            SymbolId symbol = right[i];
+            if (isTerminal(symbol)) {
+                suffixFirst.clear();
+                suffixFirst.insert(symbol);
+                suffixNullable = false;
+                continue;
+            }
+            followSets[symbol].unionWith(suffixFirst);
+            if (suffixNullable && symbol != left)
+                dependents[left].push_back(symbol);
+            if (nullable[symbol]) {
+                suffixFirst.unionWith(firstSets[symbol]);
+            } else {
+                suffixFirst = firstSets[symbol];
+                suffixNullable = false;
             }
         }
     }
+    propagateSets(followSets, dependents);
 }
 
+    // Function to get the names of a set of terminals in sorted order
+    vector<string> sortedNames(const TerminalSet& symbols, bool withEpsilon) const {
+        vector<string> names;
+        symbols.forEach([&](SymbolId symbol) {
+            names.push_back(symbolName(symbol));
+        });
+        if (withEpsilon)
+            names.push_back(symbolName(EPSILON));
+        sort(names.begin(), names.end());
+        return names;
+    }
+
     // Function to print the first sets
     void printFirstSets()  {
         cout << "FIRST Sets:" << endl;
-        for (const auto& entry : firstSets) {
-            cout << entry.first << ": { ";
-            for (const string& symbol : entry.second) {
+        for (SymbolId nonTerminal = endMarker + 1; nonTerminal < symbolNames.size(); ++nonTerminal) {
+            cout << symbolName(nonTerminal) << ": { ";
+            for (const string& symbol : sortedNames(firstSets[nonTerminal], nullable[nonTerminal])) {
                 cout << symbol << " ";
             }
             cout << "}" << endl;
@@ -218,15 +613,44 @@ void computeFollowSets() {
     // Function to print the follow sets
     void printFollowSets() {
         cout << "Follow Sets:" << endl;
-        for (const auto& pair : followSets) {
-            cout << pair.first << ": [ ";
-            for (const string& symbol : pair.second) {
+        for (SymbolId nonTerminal = endMarker + 1; nonTerminal < symbolNames.size(); ++nonTerminal) {
+            cout << symbolName(nonTerminal) << ": [ ";
+            for (const string& symbol : sortedNames(followSets[nonTerminal], false)) {
                 cout << symbol << " ";
             }
             cout << " ]" << endl;
         }
     }
 
+    // Function to print an LR(0) item with its dot
+    void printItem(const LR0Item& item) const {
+        cout << "  " << symbolName(item.lhs) << " -> ";
+        if (item.rhs.empty()) {
+            cout << ". # ";
+            return;
+        }
+        for (size_t j = 0; j < item.rhs.size(); ++j) {
+            if (static_cast<int>(j) == item.dotPosition)
+                cout << ". ";
+            cout << symbolName(item.rhs[j]) << " ";
+        }
+        if (item.dotPosition == static_cast<int>(item.rhs.size()))
+            cout << ". "; // Dot at the end
+    }
+
+    // Function to print the transitions ordered by state and symbol name
+    void printTransitions() const {
+        vector<pair<pair<int, string>, int>> sorted;
+        for (const auto& transition : transitions) {
+            sorted.push_back({{transition.first.first, symbolName(transition.first.second)}, transition.second});
+        }
+        sort(sorted.begin(), sorted.end());
+        cout << "Transitions:" << endl;
+        for (const auto& transition : sorted) {
+            cout << "I" << transition.first.first << " --" << transition.first.second << "-> I" << transition.second << endl;
+        }
+    }
+
 
     
     vector<LR0Item> generateInitialItemSet()  {
@@ -234,7 +658,7 @@ void computeFollowSets() {
         // Add the initial LR(0) item
         
         for(auto &production: productions){
-            if(production.left == startSymbol) {
+            if(production.left == startId) {
                 initialItemSet.emplace_back(production.left, production.right, 0);
                 break;
             }
@@ -256,8 +680,8 @@ vector<LR0Item> calculateClosure(vector<LR0Item>& itemSet)  {
         for (size_t i = 0; i < closure.size(); ++i) {
             LR0Item& currentItem = closure[i];
             // Check if the next symbol after the dot is a non-terminal
-            string nextSymbol = currentItem.getNextSymbol();
-            if (!nextSymbol.empty() && isNonTerminal(nextSymbol)) {
+            SymbolId nextSymbol = currentItem.getNextSymbol();
+            if (isNonTerminal(nextSymbol)) {
                 // Find productions with the next symbol as the left-hand side
                 for (const Production& production : productions) {
                     if (production.left == nextSymbol) {
@@ -276,17 +700,18 @@ vector<LR0Item> calculateClosure(vector<LR0Item>& itemSet)  {
     return closure;
 }
 
-    // Function to compute Goto transitions
-map<string, vector<LR0Item>> computeGoto(const vector<LR0Item>& itemSet, const string& symbol)  {
-    map<string, vector<LR0Item>> gotoMap;
+    // Function to compute the Goto kernels of an item set for every symbol at once.
+    // Items are bucketed by the symbol after the dot in a single pass, so only the
+    // symbols that actually occur get a Goto set; the map keeps them in ID order.
+map<SymbolId, vector<LR0Item>> computeGoto(const vector<LR0Item>& itemSet)  {
+    map<SymbolId, vector<LR0Item>> gotoMap;
     // Iterate through each item in the item set
     for (const LR0Item& item : itemSet) {
-        // Check if the next symbol after the dot matches the given symbol
-        if (!item.isComplete() && item.getNextSymbol() == symbol) {
+        if (!item.isComplete()) {
             // Create a new LR(0) item by shifting the dot
             LR0Item newItem(item.lhs, item.rhs, item.dotPosition + 1);
-            // Add the new item to the corresponding Goto set
-            gotoMap[symbol].push_back(newItem);
+            // Add the new item to the Goto set of the symbol after the dot
+            gotoMap[item.getNextSymbol()].push_back(newItem);
         }
     }
     return gotoMap;
@@ -298,6 +723,7 @@ map<string, vector<LR0Item>> computeGoto(const vector<LR0Item>& itemSet, const s
 void constructLR0Automaton() {
     
     vector<LR0Item> initialItemSet = generateInitialItemSet();
+    getOrCreateStateIndex(vector<LR0Item>(1, initialItemSet[0]));
     automaton.push_back(initialItemSet);
     
 
@@ -309,100 +735,71 @@ void constructLR0Automaton() {
         int currentIndex = itemSetQueue.front();
         itemSetQueue.pop();
 
-        // Compute Goto transitions for each symbol
-        for (const string& symbol : terminals) {
-            map<string, vector<LR0Item>> gotoMap = computeGoto(automaton[currentIndex], symbol);
-            if (!gotoMap.empty()) {
-                vector<LR0Item> nextItemSet = calculateClosure(gotoMap[symbol]);
-                int nextStateIndex = getOrCreateStateIndex(nextItemSet);
-                addTransition(currentIndex, symbol, nextStateIndex);
-                
-                if (nextStateIndex == automaton.size()) {
-                        automaton.push_back(nextItemSet);
-                        itemSetQueue.push(nextStateIndex);
-                    }
-            }
-        }
-        for (const string& symbol : nonTerminals) {
-            map<string, vector<LR0Item>> gotoMap = computeGoto(automaton[currentIndex], symbol);
-            if (!gotoMap.empty()) {
-                vector<LR0Item> nextItemSet = calculateClosure(gotoMap[symbol]);
-                int nextStateIndex = getOrCreateStateIndex(nextItemSet);
-                    addTransition(currentIndex, symbol, nextStateIndex);
-                    if (nextStateIndex == automaton.size()) {
-                        automaton.push_back(nextItemSet);
-                        itemSetQueue.push(nextStateIndex);
-                    }
+        // Compute Goto transitions for each symbol that follows a dot, terminals
+        // first and then non-terminals (symbol ID order)
+        map<SymbolId, vector<LR0Item>> gotoMap = computeGoto(automaton[currentIndex]);
+        for (auto& entry : gotoMap) {
+            SymbolId symbol = entry.first;
+            int nextStateIndex = getOrCreateStateIndex(entry.second);
+            addTransition(currentIndex, symbol, nextStateIndex);
+
+            if (nextStateIndex == automaton.size()) {
+                automaton.push_back(calculateClosure(entry.second));
+                itemSetQueue.push(nextStateIndex);
             }
         }
     }
 
     
 }
-    // Helper function to get or create the index of an LR(0) item set in the automaton
-    int getOrCreateStateIndex(const vector<LR0Item>& itemSet) {
-        for (size_t i = 0; i < automaton.size(); ++i) {
-            if (automaton[i] == itemSet) {
-                return i;
-            }
-        }
-        return automaton.size(); // Index of the new state
+    // Helper function to get or create the index of an LR(0) item set in the automaton.
+    // A state is identified by its kernel; the kernel is sorted so that the same set
+    // reached through items in a different order maps to the same state.
+    int getOrCreateStateIndex(const vector<LR0Item>& kernel) {
+        vector<LR0Item> canonical = kernel;
+        sort(canonical.begin(), canonical.end());
+        auto inserted = stateIndex.emplace(move(canonical), (int)automaton.size());
+        return inserted.first->second; // automaton.size() for a new state
     }
 
     vector<vector<Action>> constructParsingTable(){
         cout << "No of terminals :" << terminals.size()<<endl;
         cout << "No of non Terminals : "<<nonTerminals.size()<<endl;
-        vector<vector<Action>> parsingTable(automaton.size(), vector<Action>(terminals.size() + nonTerminals.size() + 1, {ActionType::ERROR, -1}));
+        vector<vector<Action>> parsingTable(automaton.size(), vector<Action>(symbolNames.size(), {ActionType::ERROR, -1}));
+
+        // Each transition is a SHIFT on a terminal or a GOTO on a non-terminal
+        for (const auto& transition : transitions) {
+            int stateIndex = transition.first.first;
+            SymbolId symbol = transition.first.second;
+            ActionType type = isTerminal(symbol) ? ActionType::SHIFT : ActionType::GOTO;
+            parsingTable[stateIndex][symbol] = {type, transition.second};
+        }
 
         // Iterate over each state in the LR(0) automaton
         for (size_t stateIndex = 0; stateIndex < automaton.size(); ++stateIndex) {
             const auto& state =  automaton[stateIndex];
 
-            // For each terminal, compute SHIFT action if applicable
-            for (size_t i = 0; i < terminals.size(); ++i) {
-                const string& terminal = *next(terminals.begin(), i);
-                //auto gotoMap = computeGoto(state, terminal);
-                auto transition = transitions.find({stateIndex,terminal});
-                if(transition != transitions.end()){
-                    int nextStateIndex = transition->second;
-                    parsingTable[stateIndex][i] = {ActionType::SHIFT, nextStateIndex};
-                }
-                
-            }
-
-            // For each non-terminal, compute GOTO action if applicable
-            for (size_t i = 0; i < nonTerminals.size(); ++i) {
-                const string& nonTerminal = *next(nonTerminals.begin(), i);
-                auto transition = transitions.find({stateIndex, nonTerminal});
-                
-                if(transition != transitions.end()){
-                    int nextStateIndex = transition->second;
-                    parsingTable[stateIndex][terminals.size() +1+ i] = {ActionType::GOTO, nextStateIndex};
-                }
-            }
-
             for (const LR0Item& item : state) {
                 // If the item is a complete item, compute REDUCE action
                 
-                if (item.rhs[0] == "#" || item.isComplete()) {
+                if (item.isComplete()) {
                     int productionIndex = getProductionIndex(item.lhs, item.rhs);
                     if(productionIndex == -1) cout << "Prodution Not found"<<endl;
-                    for (const string& terminal : followSets[item.lhs]) {
-                        if (terminal == "$") {
-                            // if( parsingTable[stateIndex][terminals.size()].type != ActionType::ERROR) cout << " Conflict found"<<endl;
-                            if(item.lhs == startSymbol){
-                                parsingTable[stateIndex][terminals.size()] = {ActionType::ACCEPT, -1};
+                    followSets[item.lhs].forEach([&](SymbolId terminal) {
+                        if (terminal == endMarker) {
+                            // if( parsingTable[stateIndex][endMarker].type != ActionType::ERROR) cout << " Conflict found"<<endl;
+                            if(item.lhs == startId){
+                                parsingTable[stateIndex][endMarker] = {ActionType::ACCEPT, -1};
                             }
                             else{
-                                parsingTable[stateIndex][terminals.size()] = {ActionType::REDUCE, productionIndex };
+                                parsingTable[stateIndex][endMarker] = {ActionType::REDUCE, productionIndex };
                             }
                             
                         } else {
-                            int terminalIndex = getTerminalIndex(terminal);
-                            //if( parsingTable[stateIndex][terminalIndex].type != ActionType::ERROR) cout << " Conflict found"<<endl;
-                            parsingTable[stateIndex][terminalIndex] = {ActionType::REDUCE, productionIndex};
+                            //if( parsingTable[stateIndex][terminal].type != ActionType::ERROR) cout << " Conflict found"<<endl;
+                            parsingTable[stateIndex][terminal] = {ActionType::REDUCE, productionIndex};
                         }
-                    }
+                    });
                 }
             }
 
@@ -449,7 +846,7 @@ void constructLR0Automaton() {
         }
     }
     
-    int getProductionIndex(const string& left, const vector<string>& right) const {
+    int getProductionIndex(SymbolId left, const vector<SymbolId>& right) const {
         for (size_t i = 0; i < productions.size(); ++i) {
             if (productions[i].left == left && productions[i].right == right) {
                 return i;
@@ -458,25 +855,17 @@ void constructLR0Automaton() {
         return -1; // Production not found
     }
 
-    int getTerminalIndex(const string &terminal){
-        auto it = find(terminals.begin(), terminals.end(), terminal);
-        if (it != terminals.end()) {
-            return distance(terminals.begin(), it);
-        }
-        return -1; // Terminal not found
-    }
-
-    int getNonTerminalIndex(const string &nonTerminal){
-        auto it = find(nonTerminals.begin(), nonTerminals.end(), nonTerminal);
-        if (it != nonTerminals.end()) {
-            return terminals.size() + 1 + distance(nonTerminals.begin(), it);
-        }
-        return -1; // Non Terminal not found
+    // Function to parse the input string using the LR(0) parsing table
+    // (either a dense vector<vector<Action>> or a CompactParsingTable)
+    template <typename Table>
+    bool parseInput(const Table& parsingTable, const vector<string>& inputTokens) {
+    // Translate the tokens to symbol IDs once; the loop below only indexes the table
+    vector<SymbolId> inputSymbols;
+    inputSymbols.reserve(inputTokens.size());
+    for (const string& token : inputTokens) {
+        inputSymbols.push_back(getSymbolId(token));
     }
 
-
-    // Function to parse the input string using the LR(0) parsing table
-    bool parseInput(const vector<vector<Action>>& parsingTable, const vector<string>& inputTokens) {
     stack<int> stateStack;
     stateStack.push(0); // Push initial state onto stack
     int inputIndex = 0; // Index to track input tokens
@@ -490,7 +879,7 @@ void constructLR0Automaton() {
 
     while (!stateStack.empty()) {
         int currentState = stateStack.top();
-        string currentInput = (inputIndex < inputTokens.size()) ? inputTokens[inputIndex] : "$";
+        SymbolId currentInput = (inputIndex < inputSymbols.size()) ? inputSymbols[inputIndex] : endMarker;
 
         // Print stack and input
          
@@ -501,7 +890,7 @@ void constructLR0Automaton() {
         cout << "\t\t";
 
         // Check if ACCEPT state is reached
-        if (parsingTable[currentState][terminals.size()].type == ActionType::ACCEPT) {
+        if (lookupAction(parsingTable, currentState, endMarker).type == ActionType::ACCEPT) {
             cout << "ACCEPT" << endl;
             acceptReached = true;
             break;
@@ -509,28 +898,25 @@ void constructLR0Automaton() {
         
 
         // Check if the current input token is a terminal
-        if (currentInput == "$" || terminals.find(currentInput) != terminals.end()) {
-            int terminalIndex = currentInput == "$" ?   terminals.size() :  getTerminalIndex(currentInput);
-            Action action = parsingTable[currentState][terminalIndex];
+        if (currentInput == endMarker || isTerminal(currentInput)) {
+            Action action = lookupAction(parsingTable, currentState, currentInput);
             if (action.type == ActionType::SHIFT) {
                 cout << "SHIFT " << action.value << endl;
                 stateStack.push(action.value);
                 ++inputIndex;
             } else if (action.type == ActionType::REDUCE) {
                 int productionIndex = action.value;
-                vector<string>& productionRHS = productions[productionIndex].right; /* Get RHS of production */
-                int numSymbolsToPop = productionRHS[0] == "#" ? 0 : productionRHS.size();
+                const vector<SymbolId>& productionRHS = productions[productionIndex].right; /* Get RHS of production */
+                int numSymbolsToPop = productionRHS.size();
                 for (int i = 0; i < numSymbolsToPop; ++i) {
                     stateStack.pop();
                 }
                 int newState = stateStack.top();
-                const string& nonTerminal = productions[productionIndex].left; /*Get Non Terminal on LHS*/
-                int nextState = parsingTable[newState][getNonTerminalIndex(nonTerminal)].value;/* Get next state from parsing table using nonTerminal */;
+                SymbolId nonTerminal = productions[productionIndex].left; /*Get Non Terminal on LHS*/
+                int nextState = lookupAction(parsingTable, newState, nonTerminal).value;/* Get next state from parsing table using nonTerminal */;
                 stateStack.push(nextState);
-                cout << "REDUCE by " << nonTerminal << " -> ";
-                for (const string& symbol : productionRHS) {
-                    cout << symbol << " ";
-                }
+                cout << "REDUCE by " << symbolName(nonTerminal) << " -> ";
+                printSymbols(productionRHS);
                 cout << endl;
             } else {
                 cout << "ERROR: Invalid action" << endl;
@@ -578,32 +964,646 @@ void constructLR0Automaton() {
         }
 
         inputFile.close();
+        internSymbols();
     }
 
 };
 
 
+// Table artifacts hold a precompiled grammar: the interned symbol names, the
+// productions and the compressed parsing table, in one binary file named after
+// a hash of the grammar file. The file is written once and then mapped
+// read-only, so later runs skip the grammar construction and concurrent runs
+// share the table pages.
+//
+// Layout (32-bit words after the header):
+//   ArtifactHeader
+//   nameOffsets[numSymbols + 1]        byte offsets into the name blob
+//   productionLeft[numProductions]
+//   productionStart[numProductions + 1] offsets into rhs
+//   rhs[rhsWords]
+//   table[table.totalWords]            base | check | actions
+//   names[nameBytes]                   symbol names, padded to a word
+const uint32_t ARTIFACT_MAGIC = 0x54524c53;   // "SLRT"
+const uint32_t ARTIFACT_VERSION = 1;
+
+struct ArtifactHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t grammarHash;
+    uint32_t numSymbols;
+    uint32_t numTerminals;
+    uint32_t startId;
+    uint32_t numProductions;
+    uint32_t rhsWords;
+    uint32_t nameBytes;
+    CompactParsingTable::Layout table;
+};
 
+// Function to hash the grammar file contents and start symbol (FNV-1a, 64 bit)
+bool hashGrammarFile(const string& filename, const string& start, uint64_t& hash) {
+    ifstream inputFile(filename, ios::binary);
+    if (!inputFile.is_open())
+        return false;
+    string contents((istreambuf_iterator<char>(inputFile)), istreambuf_iterator<char>());
+    contents += '\0';
+    contents += start;
+    hash = 14695981039346656037ull;
+    for (unsigned char c : contents) {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+    return true;
+}
 
-int main(int argc, char *argv[]) {
+// Function to get the artifact path for a grammar hash inside a cache directory
+string artifactPath(const string& cacheDir, uint64_t hash) {
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.slrt", (unsigned long long)hash);
+    return cacheDir + "/" + name;
+}
+
+// Function to write a table artifact. The file is written under a temporary
+// name and renamed into place, so a concurrent reader never sees a partial file.
+bool writeTableArtifact(const string& path, uint64_t hash, const Grammar& grammar, const CompactParsingTable& table) {
+    ArtifactHeader header = {};
+    header.magic = ARTIFACT_MAGIC;
+    header.version = ARTIFACT_VERSION;
+    header.grammarHash = hash;
+    header.numSymbols = grammar.symbolNames.size();
+    header.numTerminals = grammar.numTerminals;
+    header.startId = grammar.startId;
+    header.numProductions = grammar.productions.size();
+    header.table = table.layout;
+
+    vector<uint32_t> words;
+    string names;
+    for (const string& name : grammar.symbolNames) {
+        words.push_back(names.size());
+        names += name;
+    }
+    words.push_back(names.size());
+    names.resize((names.size() + 3) / 4 * 4, '\0');
+    header.nameBytes = names.size();
+
+    for (const Production& production : grammar.productions) {
+        words.push_back(production.left);
+    }
+    uint32_t start = 0;
+    for (const Production& production : grammar.productions) {
+        words.push_back(start);
+        start += production.right.size();
+    }
+    words.push_back(start);
+    header.rhsWords = start;
+    for (const Production& production : grammar.productions) {
+        words.insert(words.end(), production.right.begin(), production.right.end());
+    }
+    words.insert(words.end(), table.data(), table.data() + table.layout.totalWords);
+
+    string tempPath = path + ".tmp." + to_string(getpid());
+    ofstream outputFile(tempPath, ios::binary);
+    outputFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    outputFile.write(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(uint32_t));
+    outputFile.write(names.data(), names.size());
+    outputFile.close();
+    if (!outputFile || rename(tempPath.c_str(), path.c_str()) != 0) {
+        remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Class to represent a table artifact mapped read-only into memory
+class TableArtifact {
+public:
+    // Map an artifact; returns false if it is missing, corrupt, from another
+    // format version or built from different grammar contents
+    bool open(const string& path, uint64_t hash) {
+        if (!file.open(path) || file.size() < sizeof(ArtifactHeader))
+            return false;
+
+        header = reinterpret_cast<const ArtifactHeader*>(file.data());
+        if (header->magic != ARTIFACT_MAGIC || header->version != ARTIFACT_VERSION || header->grammarHash != hash)
+            return false;
+        uint64_t words = uint64_t(header->numSymbols) + 1 + 2 * uint64_t(header->numProductions) + 1
+                         + header->rhsWords + header->table.totalWords;
+        if (sizeof(ArtifactHeader) + words * sizeof(uint32_t) + header->nameBytes != file.size())
+            return false;
+        nameOffsets = reinterpret_cast<const uint32_t*>(header + 1);
+        productionLeft = nameOffsets + header->numSymbols + 1;
+        productionStart = productionLeft + header->numProductions;
+        rhs = productionStart + header->numProductions + 1;
+        tableWords = rhs + header->rhsWords;
+        names = reinterpret_cast<const char*>(tableWords + header->table.totalWords);
+        return true;
+    }
+
+    // Function to fill a grammar with the symbols and productions of the artifact
+    void loadGrammar(Grammar& grammar) const {
+        grammar.symbolNames.clear();
+        grammar.symbolIds.clear();
+        for (uint32_t id = 0; id < header->numSymbols; ++id) {
+            string name(names + nameOffsets[id], nameOffsets[id + 1] - nameOffsets[id]);
+            grammar.symbolIds.emplace(name, id);
+            if (id < header->numTerminals)
+                grammar.terminals.insert(name);
+            else if (id > header->numTerminals)
+                grammar.nonTerminals.insert(name);
+            grammar.symbolNames.push_back(move(name));
+        }
+        grammar.numTerminals = header->numTerminals;
+        grammar.endMarker = header->numTerminals;
+        grammar.startId = header->startId;
+        grammar.startSymbol = grammar.symbolNames[header->startId];
+        grammar.productions.clear();
+        for (uint32_t i = 0; i < header->numProductions; ++i) {
+            vector<SymbolId> right(rhs + productionStart[i], rhs + productionStart[i + 1]);
+            grammar.productions.emplace_back(productionLeft[i], right);
+        }
+    }
+
+    // The parsing table, reading straight from the mapped pages
+    CompactParsingTable table() const {
+        return CompactParsingTable(header->table, tableWords);
+    }
+
+private:
+    MappedFile file;
+    const ArtifactHeader* header = nullptr;
+    const uint32_t* nameOffsets = nullptr;
+    const uint32_t* productionLeft = nullptr;
+    const uint32_t* productionStart = nullptr;
+    const uint32_t* rhs = nullptr;
+    const uint32_t* tableWords = nullptr;
+    const char* names = nullptr;
+};
+
+// Function to print the tokens collected in the Symbol Table
+void printSymbolTable() {
+    cout << "Symbol Table : " << endl;
+    for (const Token& token : SymbolTable) {
+        std::cout << "Token: " << token.value << ", Line: " << token.line << ", Position: " << token.position << std::endl;
+    }
+}
+
+// Function to parse an input file with a table artifact from the cache directory,
+// building and writing the artifact first if there is none for this grammar
+int parseWithArtifact(const string& grammarfile, const string& startSymbol, const string& filename, const string& cacheDir) {
+    uint64_t hash;
+    if (!hashGrammarFile(grammarfile, startSymbol, hash)) {
+        cerr << "Error: Unable to open file " << grammarfile << endl;
+        return EXIT_FAILURE;
+    }
+    mkdir(cacheDir.c_str(), 0755);
+    string path = artifactPath(cacheDir, hash);
+
+    TableArtifact artifact;
+    if (!artifact.open(path, hash)) {
+        Grammar built;
+        built.ParseGrammar(grammarfile, startSymbol);
+        built.constructLR0Automaton();
+        built.computeFirstSets();
+        built.computeFollowSets();
+        CompactParsingTable builtTable(built.constructParsingTable());
+        if (!writeTableArtifact(path, hash, built, builtTable) || !artifact.open(path, hash)) {
+            cerr << "Error: Unable to write table artifact " << path << endl;
+            return EXIT_FAILURE;
+        }
+    }
 
-    
     Grammar grammar;
-    string grammarfile = argv[1];
+    artifact.loadGrammar(grammar);
+    CompactParsingTable parsingTable = artifact.table();
+
+    vector<string>tokens = getTokens(filename);
+    tokens.push_back("$");
+    cout << grammar.parseInput(parsingTable, tokens) << endl;
+    printSymbolTable();
+    return 0;
+}
+
+// Function to turn a grammar symbol into a C++ identifier for the generated enums
+string cppIdentifier(const string& symbol) {
+    static const map<char, string> punctuation = {
+        {'(', "LPAREN"}, {')', "RPAREN"}, {'{', "LBRACE"}, {'}', "RBRACE"}, {'[', "LBRACKET"},
+        {']', "RBRACKET"}, {';', "SEMI"}, {',', "COMMA"}, {'.', "DOT"}, {'=', "EQ"}, {'<', "LT"},
+        {'>', "GT"}, {'+', "PLUS"}, {'-', "MINUS"}, {'*', "STAR"}, {'/', "SLASH"}, {'^', "CARET"},
+        {'!', "BANG"}, {'&', "AMP"}, {'|', "PIPE"}, {'%', "PERCENT"}, {'\'', "PRIME"}};
+    string id;
+    for (char c : symbol) {
+        if (isalnum((unsigned char)c) || c == '_') {
+            id += c;
+            continue;
+        }
+        if (!id.empty() && id.back() != '_')
+            id += '_';
+        auto it = punctuation.find(c);
+        id += it != punctuation.end() ? it->second : "X" + to_string((unsigned char)c);
+    }
+    return id;
+}
+
+// Function to write an array of unsigned values as a constexpr C++ array
+// using the narrowest integer type that holds them
+template <typename Values>
+void emitCppArray(ostream& out, const string& name, const Values& values) {
+    uint64_t maxValue = 0;
+    for (auto value : values) {
+        maxValue = max<uint64_t>(maxValue, value);
+    }
+    const char* type = maxValue <= UINT8_MAX ? "uint8_t" : maxValue <= UINT16_MAX ? "uint16_t" : "uint32_t";
+    out << "constexpr " << type << " " << name << "[] = {";
+    size_t i = 0;
+    for (auto value : values) {
+        out << (i % 16 == 0 ? "\n    " : " ") << uint64_t(value) << ",";
+        ++i;
+    }
+    out << "\n};\n\n";
+}
+
+// Function to write a self-contained C++ header that parses the grammar without
+// building anything at runtime: terminal and non-terminal enums, the compressed
+// parsing table as constexpr arrays, and a parse loop whose REDUCE step is a
+// switch over the productions with their length and left-hand side as constants
+int emitCppParser(const string& grammarfile, const string& startSymbol, const string& outputPath) {
+    Grammar grammar;
+    grammar.ParseGrammar(grammarfile, startSymbol);
+    grammar.constructLR0Automaton();
+    grammar.computeFirstSets();
+    grammar.computeFollowSets();
+    CompactParsingTable table(grammar.constructParsingTable());
+    const CompactParsingTable::Layout& layout = table.layout;
+
+    // Namespace and include guard from the output file name
+    string stem = outputPath.substr(outputPath.find_last_of('/') + 1);
+    stem = cppIdentifier(stem.substr(0, stem.find('.')));
+    if (stem.empty() || isdigit((unsigned char)stem[0]))
+        stem = "grammar_" + stem;
+    string guard = stem + "_H";
+    transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+
+    // Enumerator names, made unique if two symbols sanitize to the same identifier
+    vector<string> enumerators;
+    set<string> used;
+    for (SymbolId symbol = 0; symbol < grammar.symbolNames.size(); ++symbol) {
+        string id = symbol == grammar.endMarker ? "END"
+                  : (grammar.isTerminal(symbol) ? "T_" : "N_") + cppIdentifier(grammar.symbolName(symbol));
+        if (!used.insert(id).second) {
+            id += "_" + to_string(symbol);
+            used.insert(id);
+        }
+        enumerators.push_back(id);
+    }
+
+    ofstream out(outputPath);
+    if (!out.is_open()) {
+        cerr << "Error: Unable to open file " << outputPath << endl;
+        return EXIT_FAILURE;
+    }
+    out << "// Generated from " << grammarfile << " by slr_parser2 --emit-cpp. Do not edit.\n";
+    out << "// " << grammar.automaton.size() << " states, " << grammar.productions.size() << " productions.\n";
+    out << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+    out << "#include <cstddef>\n#include <cstdint>\n#include <string_view>\n#include <vector>\n\n";
+    out << "namespace " << stem << " {\n\n";
+
+    out << "enum Terminal : uint32_t {\n";
+    for (SymbolId symbol = 0; symbol <= grammar.endMarker; ++symbol) {
+        out << "    " << enumerators[symbol] << " = " << symbol << ", // " << grammar.symbolName(symbol) << "\n";
+    }
+    out << "};\n\n";
+    out << "enum NonTerminal : uint32_t {\n";
+    for (SymbolId symbol = grammar.endMarker + 1; symbol < grammar.symbolNames.size(); ++symbol) {
+        out << "    " << enumerators[symbol] << " = " << symbol << ", // " << grammar.symbolName(symbol) << "\n";
+    }
+    out << "};\n\n";
+
+    out << "constexpr std::string_view kSymbolNames[] = {\n";
+    for (const string& name : grammar.symbolNames) {
+        out << "    \"";
+        for (char c : name) {
+            if (c == '"' || c == '\\')
+                out << '\\';
+            out << c;
+        }
+        out << "\",\n";
+    }
+    out << "};\n\n";
+
+    out << "// Get the terminal with the given name, or -1 if there is none\n";
+    out << "constexpr int findTerminal(std::string_view name) {\n";
+    out << "    for (uint32_t symbol = 0; symbol < END; ++symbol) {\n";
+    out << "        if (kSymbolNames[symbol] == name)\n";
+    out << "            return symbol;\n";
+    out << "    }\n";
+    out << "    return -1;\n";
+    out << "}\n\n";
+
+    out << "// Parsing table with row displacement: the action of (state, symbol) is\n";
+    out << "// kAction[kBase[state] + symbol] if kCheck there equals kBase[state], else ERROR.\n";
+    out << "// Actions are type << kValueBits | (value + 1).\n";
+    out << "enum ActionType : uint32_t { SHIFT = " << int(ActionType::SHIFT) << ", REDUCE = " << int(ActionType::REDUCE)
+        << ", GOTO = " << int(ActionType::GOTO) << ", ACCEPT = " << int(ActionType::ACCEPT)
+        << ", ERROR = " << int(ActionType::ERROR) << " };\n";
+    out << "constexpr uint32_t kValueBits = " << layout.valueBits << ";\n\n";
+    const uint32_t* data = table.data();
+    emitCppArray(out, "kBase", vector<uint32_t>(data, data + layout.numStates));
+    emitCppArray(out, "kCheck", vector<uint32_t>(data + layout.checkOffset, data + layout.cellOffset));
+    if (layout.wideCells) {
+        emitCppArray(out, "kAction", vector<uint32_t>(data + layout.cellOffset, data + layout.cellOffset + layout.numSlots));
+    } else {
+        const uint16_t* cells = reinterpret_cast<const uint16_t*>(data + layout.cellOffset);
+        emitCppArray(out, "kAction", vector<uint16_t>(cells, cells + layout.numSlots));
+    }
+
+    out << "constexpr uint32_t action(uint32_t state, uint32_t symbol) {\n";
+    out << "    uint32_t slot = kBase[state] + symbol;\n";
+    out << "    return kCheck[slot] == kBase[state] ? uint32_t(kAction[slot]) : uint32_t(ERROR) << kValueBits;\n";
+    out << "}\n\n";
+    out << "// Get the state after a GOTO on a non-terminal\n";
+    out << "constexpr uint32_t gotoState(uint32_t state, NonTerminal symbol) {\n";
+    out << "    return (action(state, symbol) & ((1u << kValueBits) - 1)) - 1;\n";
+    out << "}\n\n";
+
+    out << "// Parse a stream of terminals (without the final END); returns true if it is accepted\n";
+    out << "inline bool parse(const Terminal* tokens, size_t count) {\n";
+    out << "    std::vector<uint32_t> stack;\n";
+    out << "    stack.reserve(64);\n";
+    out << "    stack.push_back(0);\n";
+    out << "    size_t position = 0;\n";
+    out << "    while (true) {\n";
+    out << "        uint32_t lookahead = position < count ? tokens[position] : END;\n";
+    out << "        uint32_t cell = action(stack.back(), lookahead);\n";
+    out << "        uint32_t value = (cell & ((1u << kValueBits) - 1)) - 1;\n";
+    out << "        switch (cell >> kValueBits) {\n";
+    out << "        case SHIFT:\n";
+    out << "            stack.push_back(value);\n";
+    out << "            ++position;\n";
+    out << "            break;\n";
+    out << "        case REDUCE:\n";
+    out << "            switch (value) {\n";
+    for (size_t i = 0; i < grammar.productions.size(); ++i) {
+        const Production& production = grammar.productions[i];
+        out << "            case " << i << ": // " << grammar.symbolName(production.left) << " ->";
+        if (production.right.empty())
+            out << " #";
+        for (SymbolId symbol : production.right) {
+            out << " " << grammar.symbolName(symbol);
+        }
+        out << "\n";
+        if (!production.right.empty())
+            out << "                stack.resize(stack.size() - " << production.right.size() << ");\n";
+        out << "                stack.push_back(gotoState(stack.back(), " << enumerators[production.left] << "));\n";
+        out << "                break;\n";
+    }
+    out << "            }\n";
+    out << "            break;\n";
+    out << "        case ACCEPT:\n";
+    out << "            return true;\n";
+    out << "        default:\n";
+    out << "            return false;\n";
+    out << "        }\n";
+    out << "    }\n";
+    out << "}\n\n";
+    out << "} // namespace " << stem << "\n\n#endif // " << guard << "\n";
+    return 0;
+}
+
+// Function to print the command line usage
+void printUsage(const char* program) {
+    cerr << "Usage: " << program << " [--cache <dir>] <grammar.txt> <input_file.txt>" << endl;
+    cerr << "       " << program << " --emit-cpp <parser.h> <grammar.txt>" << endl;
+    cerr << "       " << program << " --bench [<grammar.txt> | <blocks>]" << endl;
+    cerr << "       " << program << " --bench-lexer <input_file.txt>" << endl;
+}
+
+// Function to fill a grammar with a synthetic language of the given size.
+// Each block adds its own expression sub-grammar (about a dozen LR(0) states),
+// so the automaton grows linearly with the number of blocks.
+void buildSyntheticGrammar(Grammar& grammar, int blocks) {
+    grammar.startSymbol = "P'";
+    grammar.addProduction("P'", {"P"});
+    grammar.addProduction("P", {"B", "P"});
+    grammar.addProduction("P", {"#"});
+    for (int i = 0; i < blocks; ++i) {
+        string n = to_string(i);
+        grammar.addProduction("B", {"S" + n});
+        grammar.addProduction("S" + n, {"begin" + n, "E" + n, "end" + n});
+        grammar.addProduction("E" + n, {"E" + n, "+", "T" + n});
+        grammar.addProduction("E" + n, {"T" + n});
+        grammar.addProduction("T" + n, {"T" + n, "*", "F" + n});
+        grammar.addProduction("T" + n, {"F" + n});
+        grammar.addProduction("F" + n, {"(", "E" + n, ")"});
+        grammar.addProduction("F" + n, {"id" + n});
+    }
+    grammar.internSymbols();
+}
+
+// Function to run a construction phase on fresh copies of a grammar until
+// 200 ms have passed; returns the mean time in milliseconds
+template <typename Phase>
+double timePhase(const Grammar& base, Grammar& grammar, Phase phase, int& runs) {
+    runs = 0;
+    double totalMs = 0;
+    while (runs == 0 || totalMs < 200) {
+        grammar = base;
+        auto start = chrono::steady_clock::now();
+        phase(grammar);
+        auto end = chrono::steady_clock::now();
+        totalMs += chrono::duration<double, milli>(end - start).count();
+        ++runs;
+    }
+    return totalMs / runs;
+}
+
+// Function to time lookups of the given (state, column) cells in a parsing table;
+// returns ns per lookup
+template <typename Table>
+double timeLookups(const Table& table, const vector<pair<int, uint32_t>>& cells, long long& checksum) {
+    const size_t lookups = 8000000;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < lookups; ++i) {
+        const auto& cell = cells[i % cells.size()];
+        Action action = lookupAction(table, cell.first, cell.second);
+        checksum += action.value + int(action.type);
+    }
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, nano>(end - start).count() / lookups;
+}
+
+// Function to time the LR(0) automaton, FIRST/FOLLOW and parsing table construction
+// on a grammar file or, when the argument is a number, on a synthetic grammar with
+// that many blocks, and to compare the dense and compressed parsing tables.
+int benchGrammar(const string& source) {
+    Grammar base;
+    if (!source.empty() && all_of(source.begin(), source.end(), ::isdigit)) {
+        buildSyntheticGrammar(base, stoi(source));
+    } else {
+        base.ParseGrammar(source, "M'");
+    }
+
+    Grammar grammar;
+    int runs = 0;
+    double setsMs = timePhase(base, grammar, [](Grammar& g) {
+        g.computeFirstSets();
+        g.computeFollowSets();
+    }, runs);
+    int setsRuns = runs;
+    double automatonMs = timePhase(base, grammar, [](Grammar& g) { g.constructLR0Automaton(); }, runs);
+
+    cout << "Grammar: " << source << endl;
+    cout << "Productions: " << grammar.productions.size() << endl;
+    cout << "Non-terminals: " << grammar.nonTerminals.size() << endl;
+    cout << "States: " << grammar.automaton.size() << endl;
+    cout << "Transitions: " << grammar.transitions.size() << endl;
+    cout << "FIRST/FOLLOW: " << setsMs << " ms (mean of " << setsRuns << " runs)" << endl;
+    cout << "Automaton build: " << automatonMs << " ms (mean of " << runs << " runs)" << endl;
+
+    grammar.computeFirstSets();
+    grammar.computeFollowSets();
+    vector<vector<Action>> parsingTable = grammar.constructParsingTable();
+    auto start = chrono::steady_clock::now();
+    CompactParsingTable compactTable(parsingTable);
+    auto end = chrono::steady_clock::now();
+    size_t denseBytes = CompactParsingTable::denseBytes(parsingTable);
+    cout << "Table compression: " << chrono::duration<double, milli>(end - start).count() << " ms, "
+         << compactTable.layout.numUniqueRows << " unique rows, " << compactTable.layout.numSlots << " slots" << endl;
+    cout << "Dense table: " << denseBytes << " bytes" << endl;
+    cout << "Compact table: " << compactTable.bytes() << " bytes ("
+         << 100.0 * compactTable.bytes() / denseBytes << "% of dense)" << endl;
+
+    // Look up the non-error cells (the ones a parse actually reads) in a shuffled order
+    vector<pair<int, uint32_t>> cells;
+    for (size_t state = 0; state < parsingTable.size(); ++state) {
+        for (uint32_t column = 0; column < parsingTable[state].size(); ++column) {
+            if (parsingTable[state][column].type != ActionType::ERROR)
+                cells.push_back({int(state), column});
+        }
+    }
+    uint32_t seed = 12345;
+    for (size_t i = cells.size(); i > 1; --i) {
+        seed = seed * 1664525 + 1013904223;
+        swap(cells[i - 1], cells[seed % i]);
+    }
+    long long denseSum = 0, compactSum = 0;
+    double denseNs = timeLookups(parsingTable, cells, denseSum);
+    double compactNs = timeLookups(compactTable, cells, compactSum);
+    cout << "Lookup: dense " << denseNs << " ns, compact " << compactNs << " ns"
+         << (denseSum == compactSum ? "" : " (MISMATCH)") << endl;
+    return denseSum == compactSum ? 0 : 1;
+}
+
+
+// Function to compare the stream-based getTokens with the zero-copy BufferLexer
+// on an input file: checks that both give the same tokens and reports MB/s
+int benchLexer(const string& filename) {
+    MappedFile file;
+    if (!file.open(filename)) {
+        cerr << "Error: Unable to open file " << filename << endl;
+        return EXIT_FAILURE;
+    }
+    double megabytes = file.size() / 1e6;
+
+    // Stream lexer (tokens are collected in SymbolTable as a side effect)
+    double streamMs = 0;
+    int streamRuns = 0;
+    while (streamRuns == 0 || streamMs < 500) {
+        SymbolTable.clear();
+        auto start = chrono::steady_clock::now();
+        vector<string> tokens = getTokens(filename);
+        auto end = chrono::steady_clock::now();
+        streamMs += chrono::duration<double, milli>(end - start).count();
+        ++streamRuns;
+    }
+
+    streamMs /= streamRuns;
+    cout << "Input: " << filename << " (" << file.size() << " bytes, " << SymbolTable.size() << " tokens)" << endl;
+    cout << "getTokens: " << streamMs << " ms, " << megabytes / (streamMs / 1000) << " MB/s" << endl;
+
+    // Zero-copy lexer with each set of scan kernels, including mapping the file
+    bool same = true;
+    for (const char* kernels : {"scalar", "sse2", "avx2"}) {
+        if (!selectScanKernels(kernels)) {
+            cout << "BufferLexer (" << kernels << "): not supported" << endl;
+            continue;
+        }
+        double bufferMs = 0;
+        int bufferRuns = 0;
+        vector<TokenView> views;
+        while (bufferRuns == 0 || bufferMs < 500) {
+            auto start = chrono::steady_clock::now();
+            MappedFile mapped;
+            mapped.open(filename);
+            views = scanTokens(mapped.data(), mapped.size());
+            auto end = chrono::steady_clock::now();
+            bufferMs += chrono::duration<double, milli>(end - start).count();
+            ++bufferRuns;
+        }
+
+        BufferLexer lexer(file.data(), file.size());
+        bool match = views.size() == SymbolTable.size();
+        for (size_t i = 0; match && i < views.size(); ++i) {
+            const Token& token = SymbolTable[i];
+            match = token.type == views[i].type && token.value == lexer.text(views[i])
+                && token.line == views[i].line && token.position == views[i].position;
+        }
+        same = same && match;
+
+        bufferMs /= bufferRuns;
+        cout << "BufferLexer (" << kernels << "): " << bufferMs << " ms, " << megabytes / (bufferMs / 1000)
+             << " MB/s, tokens " << (match ? "match" : "DIFFER") << endl;
+    }
+    selectScanKernels("auto");
+    return same ? 0 : 1;
+}
+
+
+int main(int argc, char *argv[]) {
+
+    if (argc > 1 && string(argv[1]) == "--bench") {
+        return benchGrammar(argc > 2 ? argv[2] : "100");
+    }
+    if (argc > 2 && string(argv[1]) == "--bench-lexer") {
+        return benchLexer(argv[2]);
+    }
+
+    // Options come before the grammar and input file names
+    string cacheDir, emitPath;
+    int arg = 1;
+    for (; arg < argc && string(argv[arg]).rfind("--", 0) == 0; ++arg) {
+        string option = argv[arg];
+        if (option == "--cache" && arg + 1 < argc) {
+            cacheDir = argv[++arg];
+        } else if (option == "--emit-cpp" && arg + 1 < argc) {
+            emitPath = argv[++arg];
+        } else {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (argc - arg != (emitPath.empty() ? 2 : 1)) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    string grammarfile = argv[arg];
     string startSymbol = "M'";
-    string filename = argv[2];
+    if (!emitPath.empty())
+        return emitCppParser(grammarfile, startSymbol, emitPath);
+    string filename = argv[arg + 1];
+    if (!cacheDir.empty())
+        return parseWithArtifact(grammarfile, startSymbol, filename, cacheDir);
+
+    Grammar grammar;
     grammar.ParseGrammar(grammarfile, startSymbol);
     
 
    grammar.constructLR0Automaton();
-   vector<vector<LR0Item>> automaton = grammar.automaton;
+   const vector<vector<LR0Item>>& automaton = grammar.automaton;
 
     cout << "Productions:" << endl;
     for (const auto& production : grammar.productions) {
-        cout << production.left << " -> ";
-        for (const string& symbol : production.right) {
-            cout << symbol << " ";
-        }
+        cout << grammar.symbolName(production.left) << " -> ";
+        grammar.printSymbols(production.right);
         cout << endl;
     }
     cout <<  endl;
@@ -626,14 +1626,7 @@ int main(int argc, char *argv[]) {
     for (size_t i = 0; i < automaton.size(); ++i) {
         cout << "I" << i << ":" << endl;
         for (const LR0Item& item : automaton[i]) {
-            cout << "  " << item.lhs << " -> ";
-            for (size_t j = 0; j < item.rhs.size(); ++j) {
-                if (static_cast<int>(j) == item.dotPosition)
-                    cout << ". ";
-                cout << item.rhs[j] << " ";
-            }
-            if (item.dotPosition == static_cast<int>(item.rhs.size()))
-                cout << ". "; // Dot at the end
+            grammar.printItem(item);
             cout << endl;
         }
         cout << endl;
@@ -641,10 +1634,7 @@ int main(int argc, char *argv[]) {
     cout << endl;
 
     // Display Transitions
-    cout << "Transitions:" << endl;
-    for (const auto& transition : grammar.transitions) {
-        cout << "I" << transition.first.first << " --" << transition.first.second << "-> I" << transition.second << endl;
-    }
+    grammar.printTransitions();
     cout << endl;
     grammar.computeFirstSets();
     grammar.printFirstSets();
@@ -663,13 +1653,11 @@ int main(int argc, char *argv[]) {
 
     vector<vector<Action>> parsingTable = grammar.constructParsingTable();
     grammar.printParsingTable(parsingTable);
-    cout << grammar.parseInput(parsingTable, tokens) << endl;
+    CompactParsingTable compactTable(parsingTable);
+    cout << grammar.parseInput(compactTable, tokens) << endl;
+
+    printSymbolTable();
 
-    cout << "Symbol Table : " << endl;
-    for (const Token& token : SymbolTable) {
-        std::cout << "Token: " << token.value << ", Line: " << token.line << ", Position: " << token.position << std::endl;
-    }
-    
 
     return 0;
 }
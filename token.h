@@ -1,6 +1,7 @@
 #ifndef TOKENS_H
 #define TOKENS_H
     #include<string>
+    #include<cstdint>
     using namespace std;
     // Token types
     enum TokenType {
@@ -21,4 +22,13 @@
         int line;
         int position;
     };
+
+    // Token that refers to its text in the source buffer instead of owning it
+    struct TokenView {
+        TokenType type;
+        uint32_t offset;    // Byte offset of the text in the source buffer
+        uint32_t length;
+        int line;
+        int position;
+    };
 #endif
\ No newline at end of file